@@ -0,0 +1,709 @@
+// cloakwork microbenchmarks
+//
+// build:  g++ -std=c++20 -O2 bench.cpp -o bench      (add -mavx2 to exercise the avx2 kernels)
+//         cl /std:c++20 /O2 /EHsc bench.cpp
+//
+// only the platform-neutral modules are enabled so the numbers can be compared across
+// windows and linux builds. each section prints time per unit of work; lower is better.
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+#define CW_ENABLE_ALL 0
+#define CW_ENABLE_COMPILE_TIME_RANDOM 1
+#define CW_ENABLE_STRING_ENCRYPTION 1
+#define CW_ENABLE_VALUE_OBFUSCATION 1
+#define CW_ENABLE_FUNCTION_OBFUSCATION 1
+#include "cloakwork.h"
+
+namespace xtea = cloakwork::string_encrypt::xtea;
+
+// keeps results observable so the optimizer can't drop the measured work
+static volatile uint64_t bench_sink = 0;
+
+// runs fn `iters` times after a short warm-up and returns nanoseconds per call
+template<typename Fn>
+static double ns_per_call(size_t iters, Fn&& fn) {
+    for (size_t i = 0; i < iters / 10 + 1; ++i) fn();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iters; ++i) fn();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(iters);
+}
+
+// the pre-optimization runtime path: every block word assembled from byte loads/stores
+static void decrypt_bytewise(uint8_t* data, size_t len, const xtea::key128& key) {
+    for (size_t i = (len / 8) * 8; i < len; ++i)
+        data[i] ^= static_cast<uint8_t>(key.k[i % 4] >> ((i % 4) * 8));
+    for (size_t i = 0; i + 7 < len; i += 8) {
+        uint32_t v0 = static_cast<uint32_t>(data[i]) | (static_cast<uint32_t>(data[i+1]) << 8)
+            | (static_cast<uint32_t>(data[i+2]) << 16) | (static_cast<uint32_t>(data[i+3]) << 24);
+        uint32_t v1 = static_cast<uint32_t>(data[i+4]) | (static_cast<uint32_t>(data[i+5]) << 8)
+            | (static_cast<uint32_t>(data[i+6]) << 16) | (static_cast<uint32_t>(data[i+7]) << 24);
+        xtea::decrypt_block(v0, v1, key);
+        for (size_t b = 0; b < 4; ++b) {
+            data[i + b] = static_cast<uint8_t>(v0 >> (b * 8));
+            data[i + 4 + b] = static_cast<uint8_t>(v1 >> (b * 8));
+        }
+    }
+}
+
+// word-wise block load/store, still one block at a time
+static void decrypt_wordwise(uint8_t* data, size_t len, const xtea::key128& key) {
+    for (size_t i = (len / 8) * 8; i < len; ++i)
+        data[i] ^= static_cast<uint8_t>(key.k[i % 4] >> ((i % 4) * 8));
+    for (size_t i = 0; i + 7 < len; i += 8) {
+        uint32_t v0 = xtea::load_block_word(data + i);
+        uint32_t v1 = xtea::load_block_word(data + i + 4);
+        xtea::decrypt_block(v0, v1, key);
+        xtea::store_block_word(data + i, v0);
+        xtea::store_block_word(data + i + 4, v1);
+    }
+}
+
+// the same kernels as string cipher policies, so the real CW_STR / CW_WSTR types can run them
+template<void (*Decrypt)(uint8_t*, size_t, const xtea::key128&)>
+struct kernel_cipher {
+    struct iv_type {};
+
+    template<typename ByteT>
+    static constexpr iv_type make_iv(const xtea::key128&, const ByteT*, size_t) { return {}; }
+
+    template<typename ByteT>
+    static void encrypt(ByteT* data, size_t len, const xtea::key128& key, const iv_type&) {
+        xtea::encrypt_buffer(data, len, key);
+    }
+
+    template<typename ByteT>
+    static void decrypt(ByteT* data, size_t len, const xtea::key128& key, const iv_type&) {
+        Decrypt(reinterpret_cast<uint8_t*>(data), len, key);
+    }
+};
+
+// the types behind CW_STR and CW_WSTR, holding a 1 KB image
+template<typename Cipher>
+using cw_str_1k = cloakwork::string_encrypt::encrypted_string<1024,
+    0x01234567, 0x89ABCDEF, 0xFEDCBA98, 0x76543210, Cipher>;
+template<typename Cipher>
+using cw_wstr_1k = cloakwork::string_encrypt::encrypted_wstring<1024 / sizeof(wchar_t),
+    0x01234567, 0x89ABCDEF, 0xFEDCBA98, 0x76543210, Cipher>;
+
+// first get() on a fresh instance, placed over the ciphertext image each call. the destructor
+// is skipped, so the re-encrypt it would do is not counted
+template<typename String, typename Unit, size_t N>
+static double first_get_ns(const Unit (&image)[N]) {
+    alignas(String) unsigned char slot[sizeof(String)];
+    return ns_per_call(2000, [&]() {
+        const String* s = new (slot) String(cloakwork::string_encrypt::detail::ciphertext_tag{}, image);
+        bench_sink = bench_sink + static_cast<uint64_t>(s->get()[0]);
+    });
+}
+
+CW_NOINLINE static int call_target(int x) { return x + 1; }
+
+// decrypts 1 KB as a sequence of `chunk`-byte xtea::decrypt_buffer calls on a plain
+// buffer; this isolates the block kernel, it does not go through CW_STR/CW_WSTR/CW_CALL
+template<typename Decrypt>
+static double ns_per_kb(size_t chunk, Decrypt&& decrypt) {
+    static const xtea::key128 key = {{0x01234567, 0x89ABCDEF, 0xFEDCBA98, 0x76543210}};
+    std::vector<uint8_t> buf(1024, 0x5A);
+    return ns_per_call(2000, [&]() {
+        for (size_t off = 0; off + chunk <= buf.size(); off += chunk)
+            decrypt(buf.data() + off, chunk, key);
+        bench_sink = bench_sink + buf[0];
+    });
+}
+
+static void bench_xtea_buffer() {
+    std::printf("[1] XTEA buffer decrypt (ns per KB, CW_XTEA_SIMD=%d)\n", CW_XTEA_SIMD);
+    std::printf("   %-34s %10s %10s %10s\n", "payload", "bytewise", "wordwise", "current");
+
+    struct payload { const char* name; size_t chunk; };
+    const payload payloads[] = {
+        { "decrypt_buffer, 1 KB chunks", 1024 },
+        { "decrypt_buffer, 64 B chunks", 64 },
+        { "decrypt_buffer, 8 B chunks",  8 },
+    };
+
+    for (const auto& p : payloads) {
+        double byte_ns = ns_per_kb(p.chunk, decrypt_bytewise);
+        double word_ns = ns_per_kb(p.chunk, decrypt_wordwise);
+        double cur_ns = ns_per_kb(p.chunk, [](uint8_t* d, size_t n, const xtea::key128& k) {
+            xtea::decrypt_buffer(d, n, k);
+        });
+        std::printf("   %-34s %10.0f %10.0f %10.0f  (%.2fx)\n",
+            p.name, byte_ns, word_ns, cur_ns, byte_ns / cur_ns);
+    }
+
+    // the real call paths. CW_STR / CW_WSTR take the kernel through their cipher policy;
+    // obfuscated_call has no policy, so it only runs the current decrypt_ptr
+    using bytewise = kernel_cipher<decrypt_bytewise>;
+    using wordwise = kernel_cipher<decrypt_wordwise>;
+    using current = cloakwork::string_encrypt::xtea_cipher;
+    static const char str_image[1024] = {};
+    static const wchar_t wstr_image[1024 / sizeof(wchar_t)] = {};
+    double str_ns[3] = { first_get_ns<cw_str_1k<bytewise>>(str_image),
+        first_get_ns<cw_str_1k<wordwise>>(str_image), first_get_ns<cw_str_1k<current>>(str_image) };
+    double wstr_ns[3] = { first_get_ns<cw_wstr_1k<bytewise>>(wstr_image),
+        first_get_ns<cw_wstr_1k<wordwise>>(wstr_image), first_get_ns<cw_wstr_1k<current>>(wstr_image) };
+    std::printf("   %-34s %10.0f %10.0f %10.0f  (%.2fx)\n", "CW_STR, first get() of 1 KB",
+        str_ns[0], str_ns[1], str_ns[2], str_ns[0] / str_ns[2]);
+    std::printf("   %-34s %10.0f %10.0f %10.0f  (%.2fx)\n", "CW_WSTR, first get() of 1 KB",
+        wstr_ns[0], wstr_ns[1], wstr_ns[2], wstr_ns[0] / wstr_ns[2]);
+
+    // 128 calls decrypt one KB of 8-byte pointers
+    cloakwork::obfuscated_call<int(int)> call(&call_target);
+    double call_ns = ns_per_call(200000, [&]() {
+        bench_sink = bench_sink + static_cast<uint64_t>(call(static_cast<int>(bench_sink & 1)));
+    });
+    double direct_ns = ns_per_call(200000, [&]() {
+        bench_sink = bench_sink + static_cast<uint64_t>(call_target(static_cast<int>(bench_sink & 1)));
+    });
+    std::printf("   %-34s %10s %10s %10.0f  (%.1f ns per call, %.1f direct)\n", "obfuscated_call, 128 calls",
+        "-", "-", call_ns * 128, call_ns, direct_ns);
+    std::printf("\n");
+}
+
+// 64 KB embedded resource, generated at compile time
+static constexpr size_t BLOB_BYTES = 64 * 1024;
+struct blob_payload { char s[BLOB_BYTES + 1]; };
+static constexpr blob_payload make_blob_payload() {
+    blob_payload p{};
+    for (size_t i = 0; i < BLOB_BYTES; ++i) p.s[i] = static_cast<char>('a' + (i * 7) % 26);
+    return p;
+}
+static constexpr blob_payload blob_source = make_blob_payload();
+
+static void bench_blob_stream() {
+    std::printf("[2] 64 KB resource: time to first byte / full pass (ns)\n");
+    constinit static cloakwork::string_encrypt::encrypted_blob<sizeof(blob_source.s)> blob(blob_source.s);
+
+    // baseline: what encrypted_string does on first get() - decrypt the whole image in place
+    static const xtea::key128 key = {{0x01234567, 0x89ABCDEF, 0xFEDCBA98, 0x76543210}};
+    std::vector<uint8_t> image(BLOB_BYTES, 0x5A);
+    double whole_ns = ns_per_call(200, [&]() {
+        xtea::decrypt_buffer(image.data(), image.size(), key);
+        bench_sink = bench_sink + image[0];
+    });
+
+    double first_ns = ns_per_call(20000, [&]() {
+        auto r = blob.open();
+        bench_sink = bench_sink + static_cast<uint8_t>(r.next()[0]);
+    });
+    double stream_ns = ns_per_call(200, [&]() {
+        for (auto chunk : blob.open())
+            bench_sink = bench_sink + static_cast<uint8_t>(chunk[0]);
+    });
+
+    std::printf("   %-34s %10.0f\n", "whole-buffer decrypt", whole_ns);
+    std::printf("   %-34s %10.0f\n", "encrypted_blob first window", first_ns);
+    std::printf("   %-34s %10.0f  (%zu B resident)\n", "encrypted_blob full stream", stream_ns,
+        sizeof(decltype(blob)::reader));
+    std::printf("\n");
+}
+
+static void bench_scoped_plaintext() {
+    std::printf("[3] scoped plaintext, 32 B literal (ns per use)\n");
+
+    // the old CW_STR_STACK: copy out of a permanently decrypted static
+    constinit static cloakwork::string_encrypt::encrypted_string<32> resident("scoped plaintext benchmark str!");
+    double shared_ns = ns_per_call(200000, []() {
+        cloakwork::string_encrypt::stack_encrypted_string<32> s(resident);
+        bench_sink = bench_sink + static_cast<uint8_t>(s.get()[0]);
+    });
+    double stack_ns = ns_per_call(200000, []() {
+        auto s = CW_STR_STACK("scoped plaintext benchmark str!");
+        bench_sink = bench_sink + static_cast<uint8_t>(s.get()[0]);
+    });
+    double layered_ns = ns_per_call(200000, []() {
+        bench_sink = bench_sink + static_cast<uint8_t>(CW_STR_LAYERED("scoped plaintext benchmark str!")[0]);
+    });
+    double lease_ns = ns_per_call(200000, []() {
+        auto s = CW_STR_LEASE("scoped plaintext benchmark str!");
+        bench_sink = bench_sink + static_cast<uint8_t>(s.view()[0]);
+    });
+
+    // a long-lived lease elsewhere (e.g. a worker holding the key) turns every other
+    // lease of the same string into a reference-count bump
+    constinit static cloakwork::string_encrypt::leased_string<32> shared("scoped plaintext benchmark str!");
+    auto outer = shared.lease();
+    double nested_ns = ns_per_call(200000, []() {
+        auto s = shared.lease();
+        bench_sink = bench_sink + static_cast<uint8_t>(s.view()[0]);
+    });
+    bench_sink = bench_sink + outer.size();
+
+    std::printf("   %-34s %10.1f  (plaintext stays resident in the static)\n", "stack copy of decrypted static", shared_ns);
+    std::printf("   %-34s %10.1f  (decrypt from sealed ciphertext)\n", "CW_STR_STACK", stack_ns);
+    std::printf("   %-34s %10.1f\n", "CW_STR_LAYERED get + rekey", layered_ns);
+    std::printf("   %-34s %10.1f  (decrypt + wipe)\n", "CW_STR_LEASE, lone lease", lease_ns);
+    std::printf("   %-34s %10.1f\n", "CW_STR_LEASE, overlapping lease", nested_ns);
+    std::printf("\n");
+}
+
+// 1 KB literal for the layered policies
+struct kb_payload { char s[1024]; };
+static constexpr kb_payload make_kb_payload() {
+    kb_payload p{};
+    for (size_t i = 0; i + 1 < sizeof(p.s); ++i) p.s[i] = static_cast<char>('A' + (i * 11) % 26);
+    return p;
+}
+static constexpr kb_payload kb_source = make_kb_payload();
+
+template<typename Policy>
+static double layered_get_ns() {
+    constinit static cloakwork::string_encrypt::layered_encrypted_string<sizeof(kb_source.s), Policy> str(kb_source.s);
+    return ns_per_call(200000, []() {
+        bench_sink = bench_sink + static_cast<uint8_t>(str.get()[0]);
+    });
+}
+
+static void bench_layered_rekey() {
+    namespace rekey = cloakwork::string_encrypt::rekey;
+    std::printf("[4] CW_STR_LAYERED get(), 1 KB literal, by rekey policy (ns per get)\n");
+
+    double every10_ns = layered_get_ns<rekey::every_n_accesses<10>>();
+    double every1000_ns = layered_get_ns<rekey::every_n_accesses<1000>>();
+    double ms_ns = layered_get_ns<rekey::every_ms<10>>();
+    double never_ns = layered_get_ns<rekey::never>();
+    double background_ns = 0;
+    {
+        rekey::background_thread rotator(std::chrono::milliseconds(10));
+        background_ns = layered_get_ns<rekey::background>();
+    }
+
+    std::printf("   %-34s %10.1f\n", "every_n_accesses<10> (default)", every10_ns);
+    std::printf("   %-34s %10.1f\n", "every_n_accesses<1000>", every1000_ns);
+    std::printf("   %-34s %10.1f\n", "every_ms<10>", ms_ns);
+    std::printf("   %-34s %10.1f  (10 ms rotator thread)\n", "background", background_ns);
+    std::printf("   %-34s %10.1f\n", "never", never_ns);
+    std::printf("\n");
+}
+
+// cycles per byte where a cycle counter is available (x86 tsc), nanoseconds per byte otherwise
+template<typename Fn>
+static double per_byte(size_t bytes, size_t iters, Fn&& fn) {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    for (size_t i = 0; i < iters / 10 + 1; ++i) fn();
+    uint64_t start = __rdtsc();
+    for (size_t i = 0; i < iters; ++i) fn();
+    return static_cast<double>(__rdtsc() - start) / static_cast<double>(iters * bytes);
+#else
+    return ns_per_call(iters, fn) / static_cast<double>(bytes);
+#endif
+}
+
+static void bench_cipher_backends() {
+    namespace se = cloakwork::string_encrypt;
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    const char* unit = "cycles/byte";
+#else
+    const char* unit = "ns/byte";
+#endif
+    std::printf("[5] string cipher backends, runtime decrypt (%s)\n", unit);
+    std::printf("   %-14s %12s %12s %12s\n", "payload", "xtea", "chacha<8>", "chacha<20>");
+
+    static const xtea::key128 key = {{0x01234567, 0x89ABCDEF, 0xFEDCBA98, 0x76543210}};
+    const se::chacha_cipher<8>::iv_type iv = { 0x0123456789ABCDEFull };
+    const size_t sizes[] = { 32, 256, 1024, 64 * 1024 };
+    for (size_t size : sizes) {
+        std::vector<uint8_t> buf(size, 0x5A);
+        size_t iters = (1u << 24) / size + 16;
+        double x = per_byte(size, iters, [&]() {
+            se::xtea_cipher::decrypt(buf.data(), size, key, {});
+            bench_sink = bench_sink + buf[0];
+        });
+        double c8 = per_byte(size, iters, [&]() {
+            se::chacha_cipher<8>::decrypt(buf.data(), size, key, iv);
+            bench_sink = bench_sink + buf[0];
+        });
+        double c20 = per_byte(size, iters, [&]() {
+            se::chacha_cipher<20>::decrypt(buf.data(), size, key, { iv.nonce });
+            bench_sink = bench_sink + buf[0];
+        });
+        char label[32];
+        std::snprintf(label, sizeof(label), "%zu B", size);
+        std::printf("   %-14s %12.2f %12.2f %12.2f\n", label, x, c8, c20);
+    }
+    std::printf("\n");
+}
+
+static void bench_format() {
+    std::printf("[6] formatting \"user=%%s id=%%d ...\" into a 128 B buffer (ns per call)\n");
+
+    char out[128];
+    const char* user = "alice";
+    int id = 4711;
+    double snprintf_ns = ns_per_call(200000, [&]() {
+        std::snprintf(out, sizeof(out), CW_STR("user=%s id=%d session=%08x"), user, id, 0xBEEFu);
+        bench_sink = bench_sink + static_cast<uint8_t>(out[5]);
+    });
+    double fmt_ns = ns_per_call(200000, [&]() {
+        CW_FMT("user=%s id=%d session=%08x").format_to(out, sizeof(out), user, id, 0xBEEFu);
+        bench_sink = bench_sink + static_cast<uint8_t>(out[5]);
+    });
+
+    std::printf("   %-34s %10.1f  (template stays decrypted in the static)\n", "snprintf(CW_STR(fmt))", snprintf_ns);
+    std::printf("   %-34s %10.1f  (decrypted per call, then wiped)\n", "CW_FMT format_to", fmt_ns);
+    std::printf("\n");
+}
+
+static void bench_string_table() {
+    std::printf("[7] message catalog, 8 entries (ns per lookup)\n");
+
+    auto& table = CW_STR_TABLE(
+        "operation completed successfully",
+        "the requested resource was not found",
+        "access denied: insufficient privileges",
+        "connection reset by remote peer",
+        "license expired, please renew",
+        "invalid argument supplied to call",
+        "timed out waiting for a response",
+        "internal error, please retry later");
+
+    char out[64];
+    size_t index = 0;
+    double copy_ns = ns_per_call(200000, [&]() {
+        table.copy(index++ & 7, out, sizeof(out));
+        bench_sink = bench_sink + static_cast<uint8_t>(out[0]);
+    });
+    double get_ns = ns_per_call(200000, [&]() {
+        bench_sink = bench_sink + static_cast<uint8_t>(table[index++ & 7][0]);
+    });
+
+    std::printf("   %-34s %10.1f  (decrypt into caller buffer)\n", "CW_STR_TABLE copy", copy_ns);
+    std::printf("   %-34s %10.1f  (per-entry cache, warm)\n", "CW_STR_TABLE get", get_ns);
+    std::printf("\n");
+}
+
+static void bench_sealed_compare() {
+    std::printf("[8] comparing input against a protected literal (ns per compare)\n");
+
+    static volatile char source[] = "administrator";
+    char input[sizeof(source)];
+    for (size_t i = 0; i < sizeof(source); ++i) input[i] = source[i];
+
+    double strcmp_ns = ns_per_call(500000, [&]() {
+        bench_sink = bench_sink + (std::strcmp(input, CW_STR("administrator")) == 0);
+    });
+    double sealed_ns = ns_per_call(500000, [&]() {
+        bench_sink = bench_sink + CW_STR_EQUALS(input, "administrator");
+    });
+    double prefix_ns = ns_per_call(500000, [&]() {
+        bench_sink = bench_sink + CW_STR_STARTS_WITH(input, "admin");
+    });
+
+    std::printf("   %-34s %10.1f  (literal stays decrypted in the static)\n", "strcmp(input, CW_STR(lit))", strcmp_ns);
+    std::printf("   %-34s %10.1f  (2 blocks, literal never decrypted)\n", "CW_STR_EQUALS", sealed_ns);
+    std::printf("   %-34s %10.1f  (1 block)\n", "CW_STR_STARTS_WITH", prefix_ns);
+    std::printf("\n");
+}
+
+// export names as an import resolver meets them: short win32 / native api names, module names,
+// and the long mangled c++ exports found in runtime libraries
+static const char* const symbol_corpus[] = {
+    "NtClose", "NtCreateFile", "NtQueryInformationProcess", "NtQuerySystemInformation",
+    "NtAllocateVirtualMemory", "NtProtectVirtualMemory", "NtWriteVirtualMemory", "NtReadVirtualMemory",
+    "NtCreateThreadEx", "NtWaitForSingleObject", "NtSetInformationThread", "NtQueryVirtualMemory",
+    "RtlInitUnicodeString", "RtlAllocateHeap", "RtlFreeHeap", "RtlGetVersion", "RtlCaptureContext",
+    "LdrLoadDll", "LdrGetProcedureAddress", "LdrGetDllHandle", "KiUserExceptionDispatcher",
+    "VirtualAlloc", "VirtualProtect", "VirtualFree", "CreateFileW", "ReadFile", "WriteFile",
+    "GetProcAddress", "LoadLibraryExW", "GetModuleHandleW", "CreateToolhelp32Snapshot",
+    "Process32FirstW", "Process32NextW", "IsDebuggerPresent", "CheckRemoteDebuggerPresent",
+    "QueryPerformanceCounter", "GetTickCount64", "WaitForSingleObjectEx", "InitializeCriticalSectionEx",
+    "kernel32.dll", "KERNELBASE.dll", "ntdll.dll", "user32.dll", "advapi32.dll", "msvcp140.dll",
+    "?_Xlength_error@std@@YAXPEBD@Z", "?_Xout_of_range@std@@YAXPEBD@Z",
+    "??0_Lockit@std@@QEAA@H@Z", "??1_Lockit@std@@QEAA@XZ",
+    "?uncaught_exception@std@@YA_NXZ", "?_Getcat@?$ctype@D@std@@SA_KPEAPEBVfacet@locale@2@PEBV42@@Z",
+    "?sputn@?$basic_streambuf@DU?$char_traits@D@std@@@std@@QEAA_JPEBD_J@Z",
+    "?_Osfx@?$basic_ostream@DU?$char_traits@D@std@@@std@@QEAAXXZ",
+    "_ZNSt6thread15_M_start_threadESt10unique_ptrINS_6_StateESt14default_deleteIS1_EEPFvvE",
+    "_ZNKSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE7compareEPKc",
+};
+
+// the pre-optimization fnv1a_runtime: one load, compare and branch per byte
+static uint32_t fnv1a_bytewise(const char* str) {
+    uint32_t hash = 0x811c9dc5;
+    while (*str) {
+        hash ^= static_cast<uint8_t>(*str++);
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+static uint32_t fnv1a_bytewise_ci(const char* str) {
+    uint32_t hash = 0x811c9dc5;
+    while (*str) {
+        char c = *str++;
+        if (c >= 'A' && c <= 'Z') c += 32;
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+static void bench_symbol_hashing() {
+    constexpr size_t count = sizeof(symbol_corpus) / sizeof(symbol_corpus[0]);
+    size_t bytes = 0;
+    for (const char* name : symbol_corpus) bytes += std::strlen(name);
+    std::printf("[9] runtime name hashing, %zu-name symbol corpus, %.1f B average (ns per name)\n",
+        count, static_cast<double>(bytes) / count);
+
+    // whole corpus, and only the long (>= 48 byte) mangled names
+    auto corpus = [](auto hash_fn, size_t min_length) {
+        size_t names = 0;
+        for (const char* name : symbol_corpus) names += std::strlen(name) >= min_length;
+        return ns_per_call(20000, [&]() {
+            uint32_t acc = 0;
+            for (const char* name : symbol_corpus)
+                if (std::strlen(name) >= min_length) acc += hash_fn(name);
+            bench_sink = bench_sink + acc;
+        }) / names;
+    };
+    namespace hash = cloakwork::hash;
+    auto row = [&](const char* label, auto hash_fn) {
+        std::printf("   %-34s %10.2f %10.2f\n", label, corpus(hash_fn, 0), corpus(hash_fn, 48));
+    };
+    std::printf("   %-34s %10s %10s\n", "", "all", ">= 48 B");
+    row("fnv1a, bytewise (old)", [](const char* s) { return fnv1a_bytewise(s); });
+    row("fnv1a_runtime", [](const char* s) { return hash::fnv1a_runtime(s); });
+    row("fnv1a ci, bytewise (old)", [](const char* s) { return fnv1a_bytewise_ci(s); });
+    row("fnv1a_runtime_ci", [](const char* s) { return hash::fnv1a_runtime_ci(s); });
+    row("lane32_runtime", [](const char* s) { return hash::lane32_runtime(s); });
+    row("lane32_runtime_ci", [](const char* s) { return hash::lane32_runtime_ci(s); });
+    std::printf("\n");
+}
+
+// the pre-batching runtime_entropy: one thread_local xorshift64* step per key word
+static uint64_t xorshift_entropy() {
+    thread_local uint64_t state = 0x9E3779B97F4A7C15ull ^ reinterpret_cast<uintptr_t>(&state);
+    uint64_t x = state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static void bench_runtime_keys() {
+    std::printf("[10] runtime key generation\n");
+    constexpr size_t words = 4096;
+    static uint64_t out[words];
+
+    double old_ns = ns_per_call(2000, [&]() {
+        for (size_t i = 0; i < words; ++i) out[i] = xorshift_entropy();
+        bench_sink = bench_sink + out[words - 1];
+    }) / words;
+    double single_ns = ns_per_call(2000, [&]() {
+        for (size_t i = 0; i < words; ++i) out[i] = cloakwork::detail::runtime_entropy();
+        bench_sink = bench_sink + out[words - 1];
+    }) / words;
+    double fill_ns = ns_per_call(2000, [&]() {
+        cloakwork::detail::runtime_entropy_fill(out);
+        bench_sink = bench_sink + out[words - 1];
+    }) / words;
+
+    // construction cost of obfuscated values: the runtime-keyed types draw two key words each,
+    // obfuscated_value_ct only encodes
+    constexpr size_t values = 1024;
+    double value_ns = ns_per_call(2000, [&]() {
+        std::vector<cloakwork::obfuscated_value<uint32_t>> array(values);
+        bench_sink = bench_sink + array.size();
+    }) / values;
+    double mba_ns = ns_per_call(2000, [&]() {
+        std::vector<cloakwork::mba_obfuscated<uint32_t>> array(values);
+        bench_sink = bench_sink + array.size();
+    }) / values;
+    double ct_ns = ns_per_call(2000, [&]() {
+        std::vector<cloakwork::obfuscated_value_ct<uint32_t, CW_RANDOM_CT(), CW_RANDOM_CT()>> array(values);
+        bench_sink = bench_sink + array.size();
+    }) / values;
+
+    std::printf("   %-34s %10.2f ns/word\n", "xorshift64* per call (old)", old_ns);
+    std::printf("   %-34s %10.2f ns/word\n", "runtime_entropy()", single_ns);
+    std::printf("   %-34s %10.2f ns/word\n", "runtime_entropy_fill(4096)", fill_ns);
+    std::printf("   %-34s %10.2f ns/value\n", "obfuscated_value<u32> x1024", value_ns);
+    std::printf("   %-34s %10.2f ns/value\n", "mba_obfuscated<u32> x1024", mba_ns);
+    std::printf("   %-34s %10.2f ns/value\n", "obfuscated_value_ct<u32> x1024", ct_ns);
+    std::printf("\n");
+}
+
+static void bench_bulk_values() {
+    constexpr size_t count = 10000;
+    std::printf("[11] bulk protected values, %zu x uint32_t\n", count);
+    static uint32_t plain[count], out[count];
+    for (size_t i = 0; i < count; ++i) plain[i] = static_cast<uint32_t>(i * 2654435761u);
+
+    std::vector<cloakwork::obfuscated_value<uint32_t>> values(plain, plain + count);
+    auto array = std::make_unique<cloakwork::obfuscated_array<uint32_t, count>>(plain);
+
+    double value_ns = ns_per_call(200, [&]() {
+        for (size_t i = 0; i < count; ++i) out[i] = values[i].get();
+        bench_sink = bench_sink + out[count - 1];
+    }) / count;
+    double index_ns = ns_per_call(200, [&]() {
+        for (size_t i = 0; i < count; ++i) out[i] = (*array)[i];
+        bench_sink = bench_sink + out[count - 1];
+    }) / count;
+    double read_ns = ns_per_call(2000, [&]() {
+        array->read(0, out, count);
+        bench_sink = bench_sink + out[count - 1];
+    }) / count;
+
+    std::printf("   %-34s %10.2f ns/value %6zu B/value\n", "obfuscated_value<u32>::get",
+        value_ns, sizeof(cloakwork::obfuscated_value<uint32_t>));
+    std::printf("   %-34s %10.2f ns/value %6.2f B/value\n", "obfuscated_array operator[]",
+        index_ns, static_cast<double>(sizeof(*array)) / count);
+    std::printf("   %-34s %10.2f ns/value\n", "obfuscated_array read()", read_ns);
+    std::printf("\n");
+}
+
+// the pre-sampling get(): every read bumped a per-object atomic counter
+struct counted_value {
+    cloakwork::obfuscated_value<uint32_t> value;
+    mutable std::atomic<uint32_t> access_count{0};
+
+    uint32_t get() const {
+        if ((++access_count % 1000) == 0) bench_sink = bench_sink + 1;
+        return value.get();
+    }
+};
+
+static void bench_concurrent_reads() {
+    unsigned cores = std::thread::hardware_concurrency();
+    if (cores == 0) cores = 1;
+    std::printf("[12] concurrent reads of one shared obfuscated_value<u32>, %u hardware threads (ns per read, wall / total reads)\n", cores);
+    constexpr size_t reads = 2000000;
+
+    counted_value counted{cloakwork::obfuscated_value<uint32_t>(42)};
+    cloakwork::obfuscated_value<uint32_t> shared(42);
+
+    // each thread does `reads` reads; returns wall nanoseconds divided by all reads
+    auto run = [&](unsigned threads, auto read) {
+        std::atomic<bool> go{false};
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t)
+            pool.emplace_back([&]() {
+                while (!go.load(std::memory_order_acquire)) {}
+                uint32_t acc = 0;
+                for (size_t i = 0; i < reads; ++i) acc += read();
+                bench_sink = bench_sink + acc;
+            });
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& thread : pool) thread.join();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count() / (static_cast<double>(reads) * threads);
+    };
+
+    std::printf("   %-10s %18s %18s\n", "threads", "atomic counter", "sampled");
+    for (unsigned threads = 1;; threads *= 2) {
+        if (threads > cores) threads = cores;
+        double old_ns = run(threads, [&]() { return counted.get(); });
+        double new_ns = run(threads, [&]() { return shared.get(); });
+        std::printf("   %-10u %18.2f %18.2f\n", threads, old_ns, new_ns);
+        if (threads == cores) break;
+    }
+    std::printf("\n");
+}
+
+static void bench_counter_updates() {
+    std::printf("[13] protected counter updates, obfuscated_value<u32> (ns per op)\n");
+    constexpr size_t ops = 100000;
+    cloakwork::obfuscated_value<uint32_t> counter(0);
+
+    double round_trip_ns = ns_per_call(100, [&]() {
+        for (size_t i = 0; i < ops; ++i) counter = counter + 1u;
+        bench_sink = bench_sink + counter.get();
+    }) / ops;
+    double fused_ns = ns_per_call(100, [&]() {
+        for (size_t i = 0; i < ops; ++i) ++counter;
+        bench_sink = bench_sink + counter.get();
+    }) / ops;
+    double add_ns = ns_per_call(100, [&]() {
+        for (size_t i = 0; i < ops; ++i) counter += static_cast<uint32_t>(i);
+        bench_sink = bench_sink + counter.get();
+    }) / ops;
+
+    // equality against a constant: decode and compare, or encode the constant
+    double decoded_ns = ns_per_call(100, [&]() {
+        uint32_t hits = 0;
+        for (size_t i = 0; i < ops; ++i) hits += counter.get() == static_cast<uint32_t>(i);
+        bench_sink = bench_sink + hits;
+    }) / ops;
+    double encoded_ns = ns_per_call(100, [&]() {
+        uint32_t hits = 0;
+        for (size_t i = 0; i < ops; ++i) hits += counter == static_cast<uint32_t>(i);
+        bench_sink = bench_sink + hits;
+    }) / ops;
+
+    std::printf("   %-34s %10.2f\n", "v = v + 1 (get + set)", round_trip_ns);
+    std::printf("   %-34s %10.2f\n", "++v (encoded shift)", fused_ns);
+    std::printf("   %-34s %10.2f\n", "v += i (encoded shift)", add_ns);
+    std::printf("   %-34s %10.2f\n", "v.get() == k", decoded_ns);
+    std::printf("   %-34s %10.2f\n", "v == k (encoded compare)", encoded_ns);
+    std::printf("\n");
+}
+
+static void bench_mba_depth() {
+    std::printf("[14] mba rewrite depth, uint32 add in a dependent chain (ns per add, modeled alu ops)\n");
+    constexpr size_t ops = 1 << 16;
+    static uint32_t data[1024];
+    for (size_t i = 0; i < 1024; ++i) data[i] = static_cast<uint32_t>(i * 2654435761u);
+
+    // acc ^ (acc >> 7) keeps each add dependent on the last so the loop can't be vectorized
+    auto chain = [&](auto add) {
+        return ns_per_call(200, [&]() {
+            uint32_t acc = 1;
+            for (size_t i = 0; i < ops; ++i) acc = add(acc ^ (acc >> 7), data[i & 1023]);
+            bench_sink = bench_sink + acc;
+        }) / ops;
+    };
+    using site = cloakwork::mba::rewriter<0x5EED1234u>;
+    constexpr auto add_op = cloakwork::mba::op::add;
+    auto row = [&](const char* label, double ns, int cost) {
+        std::printf("   %-34s %10.2f %10d\n", label, ns, cost);
+    };
+
+    row("a + b", chain([](uint32_t a, uint32_t b) { return a + b; }), 1);
+    row("CW_ADD (fixed identity)", chain([](uint32_t a, uint32_t b) { return CW_ADD(a, b); }), 4);
+    row("rewriter add<1>", chain([](uint32_t a, uint32_t b) { return site::add<1>(a, b); }), site::cost(add_op, 1));
+    row("rewriter add<2>", chain([](uint32_t a, uint32_t b) { return site::add<2>(a, b); }), site::cost(add_op, 2));
+    row("rewriter add<4>", chain([](uint32_t a, uint32_t b) { return site::add<4>(a, b); }), site::cost(add_op, 4));
+    row("rewriter add<8>", chain([](uint32_t a, uint32_t b) { return site::add<8>(a, b); }), site::cost(add_op, 8));
+    constexpr int budget_depth = site::depth_for(add_op, 12);
+    row("rewriter add, budget 12 ops", chain([](uint32_t a, uint32_t b) { return site::add<budget_depth>(a, b); }),
+        site::cost(add_op, budget_depth));
+    std::printf("\n");
+}
+
+int main() {
+    std::printf("=== CLOAKWORK MICROBENCHMARKS ===\n\n");
+    bench_xtea_buffer();
+    bench_blob_stream();
+    bench_scoped_plaintext();
+    bench_layered_rekey();
+    bench_cipher_backends();
+    bench_format();
+    bench_string_table();
+    bench_sealed_compare();
+    bench_symbol_hashing();
+    bench_runtime_keys();
+    bench_bulk_values();
+    bench_concurrent_reads();
+    bench_counter_updates();
+    bench_mba_depth();
+    return static_cast<int>(bench_sink & 0);
+}
@@ -0,0 +1,45 @@
+// cloakwork compile-time benchmark: 1,000 distinct CW_STR literals in one translation unit
+//
+// measure wall time and peak memory of the compile step, e.g.
+//   /usr/bin/time -v g++ -std=c++20 -O2 -c bench_compile.cpp -o /dev/null
+//   /usr/bin/time -v clang++ -std=c++20 -O2 -c bench_compile.cpp -o /dev/null
+//   add -DCW_STR_FAST_BUILD=1 to compare the build-time-optimized path
+//
+// literals cycle through ten base texts of 3..120 characters so the length spread
+// resembles real code; __COUNTER__ makes every literal unique.
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#define CW_ENABLE_ALL 0
+#define CW_ENABLE_COMPILE_TIME_RANDOM 1
+#define CW_ENABLE_STRING_ENCRYPTION 1
+#include "cloakwork.h"
+
+#define BC_STR2(x) #x
+#define BC_STR(x) BC_STR2(x)
+
+#define BC_USE(text) sum += static_cast<unsigned char>(CW_STR(text BC_STR(__COUNTER__))[0]);
+
+#define BC_X10 \
+    BC_USE("id") \
+    BC_USE("config") \
+    BC_USE("settings.json") \
+    BC_USE("https://api.example.com/") \
+    BC_USE("Software\\Microsoft\\Windows\\") \
+    BC_USE("failed to open the license file: ") \
+    BC_USE("the quick brown fox jumps over the lazy dog ") \
+    BC_USE("SELECT id, name, created_at FROM accounts WHERE ") \
+    BC_USE("Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) ") \
+    BC_USE("-----BEGIN PUBLIC KEY-----MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEAu1SU1LfVLPHCozMxH2Mo ")
+
+#define BC_X100 BC_X10 BC_X10 BC_X10 BC_X10 BC_X10 BC_X10 BC_X10 BC_X10 BC_X10 BC_X10
+
+int main() {
+    unsigned sum = 0;
+    BC_X100 BC_X100 BC_X100 BC_X100 BC_X100
+    BC_X100 BC_X100 BC_X100 BC_X100 BC_X100
+    std::printf("%u\n", sum);
+    return 0;
+}
@@ -519,15 +519,15 @@ int main() {
     std::cout << CW_STR("[14] Compile-Time String Hashing Demo") << std::endl;
 
     // compile-time hash - computed at build time
-    constexpr uint32_t kernel32_hash = CW_HASH("kernel32.dll");
-    constexpr uint32_t ntdll_hash = CW_HASH("ntdll.dll");
+    constexpr cloakwork::hash::hash_t kernel32_hash = CW_HASH("kernel32.dll");
+    constexpr cloakwork::hash::hash_t ntdll_hash = CW_HASH("ntdll.dll");
 
     std::cout << CW_STR("   hash of 'kernel32.dll': 0x") << std::hex << kernel32_hash << std::dec << std::endl;
     std::cout << CW_STR("   hash of 'ntdll.dll': 0x") << std::hex << ntdll_hash << std::dec << std::endl;
 
     // runtime hash comparison
     auto test_str = CW_STR("kernel32.dll");
-    uint32_t runtime_hash = CW_HASH_RT(test_str);
+    cloakwork::hash::hash_t runtime_hash = CW_HASH_RT(test_str);
     std::cout << CW_STR("   runtime hash matches compile-time: ") << (runtime_hash == kernel32_hash ? CW_STR("yes") : CW_STR("no")) << std::endl;
 
     std::cout << std::endl;
@@ -0,0 +1,129 @@
+// cloakwork hash collision audit
+//
+// build:  g++ -std=c++20 -O2 hash_audit.cpp -o hash_audit
+//         cl /std:c++20 /O2 /EHsc hash_audit.cpp
+//
+// usage:  hash_audit [symbols.txt]      (reads stdin when no file is given)
+//
+// takes a symbol dump with one name per line, e.g. the export names of every dll an import
+// resolver will walk (dumpbin /exports, nm -D --defined-only, objdump -T, ...). duplicate
+// names are dropped. for each hash width it reports how many distinct names share a hash with
+// another name: the exact-name hash used by CW_HASH / CW_GET_PROC, and the case-insensitive one
+// used by CW_HASH_CI for module names. a nonzero 32-bit count means CW_HASH_BITS=64 is needed
+// for that symbol set, or a hit has to be confirmed with a string compare.
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define CW_ENABLE_ALL 0
+#include "cloakwork.h"
+
+namespace hash = cloakwork::hash;
+
+struct audit_result {
+    size_t colliding_names = 0;
+    size_t groups = 0;
+    std::vector<std::vector<size_t>> examples;
+};
+
+template<typename H, typename HashFn>
+static audit_result audit(const std::vector<std::string>& names, HashFn hash_fn) {
+    std::vector<std::pair<H, size_t>> hashed;
+    hashed.reserve(names.size());
+    for (size_t i = 0; i < names.size(); ++i)
+        hashed.emplace_back(hash_fn(names[i].data(), names[i].size()), i);
+    std::sort(hashed.begin(), hashed.end());
+
+    audit_result result;
+    for (size_t i = 0; i < hashed.size();) {
+        size_t j = i + 1;
+        while (j < hashed.size() && hashed[j].first == hashed[i].first) ++j;
+        if (j - i > 1) {
+            result.colliding_names += j - i;
+            ++result.groups;
+            if (result.examples.size() < 8) {
+                std::vector<size_t> group;
+                for (size_t k = i; k < j; ++k) group.push_back(hashed[k].second);
+                result.examples.push_back(std::move(group));
+            }
+        }
+        i = j;
+    }
+    return result;
+}
+
+static void report(const char* label, const audit_result& result, const std::vector<std::string>& names) {
+    std::printf("   %-30s %10zu names in %zu groups\n", label, result.colliding_names, result.groups);
+    for (const auto& group : result.examples) {
+        std::printf("      ");
+        for (size_t index : group) std::printf(" %s", names[index].c_str());
+        std::printf("\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    FILE* input = stdin;
+    if (argc > 1) {
+        input = std::fopen(argv[1], "rb");
+        if (!input) {
+            std::fprintf(stderr, "hash_audit: cannot open %s\n", argv[1]);
+            return 2;
+        }
+    }
+
+    std::vector<std::string> names;
+    std::string line;
+    for (int c; (c = std::fgetc(input)) != EOF;) {
+        if (c != '\n') {
+            line.push_back(static_cast<char>(c));
+            continue;
+        }
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) names.push_back(std::move(line));
+        line.clear();
+    }
+    if (!line.empty()) names.push_back(std::move(line));
+    if (input != stdin) std::fclose(input);
+
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    // case-insensitive hashing treats names differing only in case as one name
+    std::vector<std::string> folded = names;
+    for (auto& name : folded)
+        for (auto& c : name)
+            if (c >= 'A' && c <= 'Z') c += 32;
+    std::sort(folded.begin(), folded.end());
+    folded.erase(std::unique(folded.begin(), folded.end()), folded.end());
+
+    std::printf("=== CLOAKWORK HASH AUDIT ===\n\n");
+    std::printf("%zu distinct names (%zu case-insensitive), built with CW_HASH_BITS=%d\n\n",
+        names.size(), folded.size(), CW_HASH_BITS);
+
+    auto fnv32 = audit<uint32_t>(names, hash::fnv1a_as<uint32_t>);
+    auto fnv64 = audit<uint64_t>(names, hash::fnv1a_as<uint64_t>);
+    auto fnv32_ci = audit<uint32_t>(folded, hash::fnv1a_ci_as<uint32_t>);
+    auto fnv64_ci = audit<uint64_t>(folded, hash::fnv1a_ci_as<uint64_t>);
+
+    std::printf("colliding names per width\n");
+    report("fnv1a 32 (CW_HASH)", fnv32, names);
+    report("fnv1a 64 (CW_HASH)", fnv64, names);
+    report("fnv1a 32 ci (CW_HASH_CI)", fnv32_ci, folded);
+    report("fnv1a 64 ci (CW_HASH_CI)", fnv64_ci, folded);
+
+    // birthday bound: expected colliding pairs for n uniformly hashed names
+    double n = static_cast<double>(names.size());
+    std::printf("\nexpected colliding pairs for random hashes: 32-bit %.3g, 64-bit %.3g\n",
+        n * (n - 1) / 2 / 4294967296.0, n * (n - 1) / 2 / 18446744073709551616.0);
+
+    bool collisions = fnv32.groups || fnv32_ci.groups;
+    bool collisions_64 = fnv64.groups || fnv64_ci.groups;
+    if (collisions_64) std::printf("\nCOLLISIONS at 64 bits: confirm hits with a string compare\n");
+    else if (collisions) std::printf("\ncollisions at 32 bits only: build with CW_HASH_BITS=64\n");
+    else std::printf("\nno collisions at either width\n");
+    return (CW_HASH_BITS == 64 ? collisions_64 : collisions) ? 1 : 0;
+}